@@ -0,0 +1,244 @@
+/*
+ * Hand-written scanner for calc, an alternative to calc.l with the same
+ * token contract. Build it in place of the flex scanner:
+ *
+ *     bison -d calc.y
+ *     gcc calc.tab.c calc_lexer.c -o calc -lm
+ *
+ * Input is read in large chunks. Each call to fill_batch() scans a whole
+ * line of tokens, which yylex() then hands to the parser one at a time.
+ * Batches stop at a newline so an interactive session still prints each
+ * result as soon as its line is entered. Unknown characters are kept in
+ * the batch and reported only when yylex() reaches them, so the messages
+ * come out exactly when flex would print them, and not at all for input
+ * after a parse error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "calc.tab.h"  /* Bison header file for token definitions */
+
+#define CHUNK 65536     // bytes requested from read() at a time
+#define PAD 16          // readable bytes past the end, for the SSE2 loads
+#define BATCH 256       // most tokens scanned ahead of the parser
+#define NEED_MORE (-2)  // a token may continue past the buffered input
+#define UNKNOWN (-1)    // batch entry for an unknown character
+
+/* Character classes, so the main loop does one table lookup per byte */
+enum { C_OTHER, C_SPACE, C_DIGIT, C_ALPHA, C_PUNCT };
+
+static unsigned char char_class[256];
+
+/* Keywords are all four letters long; ((s[3] >> 2) + s[1]) & 7 is a perfect hash over them */
+static const struct { char word[5]; int token; } keywords[8] = {
+    [1] = {"COSH", T_COSH},
+    [2] = {"quit", T_QUIT},
+    [3] = {"SINH", T_SINH},
+    [5] = {"exit", T_QUIT},
+    [6] = {"ASIN", T_ASIN},
+    [7] = {"ACOS", T_ACOS},
+};
+
+/* Exact powers of ten; any double up to 1e22 is representable */
+static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static char *buf;                // buffered input, NUL sentinel at buf[len]
+static size_t len, pos, cap;
+static int at_eof;
+
+static int batch_tokens[BATCH];
+static float batch_values[BATCH];  // the number, or the character for UNKNOWN
+static int batch_len, batch_pos;
+
+static void init_scanner(void) {
+    char_class[' '] = char_class['\t'] = C_SPACE;
+    for (int c = '0'; c <= '9'; c++) char_class[c] = C_DIGIT;
+    for (int c = 'a'; c <= 'z'; c++) char_class[c] = C_ALPHA;
+    for (int c = 'A'; c <= 'Z'; c++) char_class[c] = C_ALPHA;
+    char_class['\n'] = char_class['+'] = char_class['-'] = C_PUNCT;
+    char_class['('] = char_class[')'] = C_PUNCT;
+
+    cap = CHUNK;
+    buf = malloc(cap + PAD);
+    if (buf == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    buf[0] = '\0';
+}
+
+/* Drop consumed input and read more; returns 0 at end of input */
+static int refill(void) {
+    if (at_eof) return 0;
+    memmove(buf, buf + pos, len - pos);
+    len -= pos;
+    pos = 0;
+    if (cap - len < CHUNK / 2) {  // a single token is filling the buffer
+        cap *= 2;
+        buf = realloc(buf, cap + PAD);
+        if (buf == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+    }
+
+    ssize_t n = read(STDIN_FILENO, buf + len, cap - len);
+    if (n <= 0) {
+        at_eof = 1;
+        buf[len] = '\0';
+        return 0;
+    }
+    len += n;
+    buf[len] = '\0';
+    return 1;
+}
+
+static size_t skip_spaces(size_t i) {
+#ifdef __SSE2__
+    // 16 bytes at a time while the whole block is buffered input
+    const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+    while (i + 16 <= len) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(buf + i));
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab));
+        unsigned int mask = ~_mm_movemask_epi8(blank) & 0xFFFF;
+        if (mask != 0) return i + __builtin_ctz(mask);
+        i += 16;
+    }
+#endif
+    while (i < len && char_class[(unsigned char)buf[i]] == C_SPACE) i++;
+    return i;
+}
+
+/*
+ * Convert [0-9]+(\.[0-9]+)? starting at s. Up to 19 digits with a value
+ * below 2^53 and at most 22 fraction digits, mant / 10^frac is exact
+ * division of two exact doubles and therefore correctly rounded. Anything
+ * else goes through strtod().
+ */
+static double to_number(const char *s, size_t n) {
+    unsigned long long mant = 0;
+    int digits = 0, frac = -1;
+    for (size_t i = 0; i < n; i++) {
+        if (s[i] == '.') {
+            frac = 0;
+            continue;
+        }
+        mant = mant * 10 + (s[i] - '0');
+        digits++;
+        if (frac >= 0) frac++;
+    }
+    if (frac < 0) frac = 0;
+    if (digits <= 19 && mant < (1ULL << 53) && frac <= 22)
+        return (double)mant / powers_of_ten[frac];
+
+    char *tmp = malloc(n + 1);
+    if (tmp == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    memcpy(tmp, s, n);
+    tmp[n] = '\0';
+    double d = strtod(tmp, NULL);
+    free(tmp);
+    return d;
+}
+
+/*
+ * Scan one token at pos. Returns the token, 0 at end of input, UNKNOWN
+ * (with the character in *value) for a character no rule matches, or
+ * NEED_MORE if the token could run past the buffered input.
+ */
+static int scan_token(float *value) {
+    size_t i = skip_spaces(pos);
+    if (i == len) {
+        pos = i;
+        return at_eof ? 0 : NEED_MORE;
+    }
+
+    const char *s = buf + i;
+    switch (char_class[(unsigned char)*s]) {
+    case C_DIGIT: {
+        // buf[len] is a NUL sentinel, so these loops stop at the end of input
+        size_t n = 1;
+        while (char_class[(unsigned char)s[n]] == C_DIGIT) n++;
+        if (s[n] == '.') {
+            size_t m = n + 1;
+            while (char_class[(unsigned char)s[m]] == C_DIGIT) m++;
+            if (i + m == len && !at_eof) return NEED_MORE;
+            if (m > n + 1) n = m;  // "1." is the number 1 followed by an unknown '.'
+        }
+        if (i + n == len && !at_eof) return NEED_MORE;
+        *value = to_number(s, n);
+        pos = i + n;
+        return T_FLOAT;
+    }
+    case C_PUNCT:
+        pos = i + 1;
+        switch (*s) {
+        case '\n': return T_NEWLINE;
+        case '+':  return T_PLUS;
+        case '-':  return T_MINUS;
+        case '(':  return T_LEFT;
+        default:   return T_RIGHT;
+        }
+    case C_ALPHA:
+        // A letter outside a keyword is an unknown character. Only wait
+        // for more input while the buffered letters could still be one.
+        if (i + 4 > len && !at_eof) {
+            size_t k = 1;
+            while (char_class[(unsigned char)s[k]] == C_ALPHA) k++;
+            if (i + k == len) return NEED_MORE;
+        }
+        if (i + 4 <= len) {
+            int h = (((unsigned char)s[3] >> 2) + (unsigned char)s[1]) & 7;
+            if (memcmp(s, keywords[h].word, 4) == 0) {
+                pos = i + 4;
+                return keywords[h].token;
+            }
+        }
+        /* fall through */
+    default:
+        *value = (unsigned char)*s;
+        pos = i + 1;
+        return UNKNOWN;
+    }
+}
+
+/* Scan ahead up to the end of the current line (or BATCH tokens) */
+static void fill_batch(void) {
+    batch_len = batch_pos = 0;
+    while (batch_len < BATCH) {
+        float value = 0;
+        int token = scan_token(&value);
+        if (token == NEED_MORE) {
+            refill();
+            continue;
+        }
+
+        batch_tokens[batch_len] = token;
+        batch_values[batch_len++] = value;
+        if (token == 0 || token == T_NEWLINE) break;
+    }
+}
+
+int yylex(void) {
+    if (buf == NULL) init_scanner();
+    for (;;) {
+        if (batch_pos == batch_len) fill_batch();
+        int token = batch_tokens[batch_pos];
+        float value = batch_values[batch_pos++];
+        if (token != UNKNOWN) {
+            yylval.fval = value;
+            return token;
+        }
+        printf("Unknown character: %c\n", (char)value);
+    }
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+# Differential test and tokens/sec benchmark: flex scanner (calc.l) vs the
+# hand-written one (calc_lexer.c). Needs bison, flex and a C compiler.
+#
+#     ./compare_scanners.sh [benchmark-lines]
+#
+# Fails if the token streams (with the "Unknown character" messages) differ.
+
+set -e
+cd "$(dirname "$0")"
+LINES=${1:-400000}
+CC=${CC:-gcc}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+bison -d -o "$WORK/calc.tab.c" calc.y
+$CC -O2 -I"$WORK" lex_driver.c calc_lexer.c -o "$WORK/driver_hand"
+if command -v flex >/dev/null 2>&1; then
+    flex -o "$WORK/lex.yy.c" calc.l
+    $CC -O2 -I"$WORK" -I. lex_driver.c "$WORK/lex.yy.c" -o "$WORK/driver_flex"
+else
+    echo "flex not found: only benchmarking calc_lexer.c" >&2
+fi
+
+# Hand-picked edge cases, then random mixes of the same pieces
+printf '1+2\nSINH(1)-3.25\n(4)\nfoo 2\n1.5.3\n1.\n.5\nexi\nexitquit\n\t 007.250 \n' > "$WORK/case0"
+printf '9007199254740993\n123456789012345678901234567890.5\n0.1234567890123456789012345\n' >> "$WORK/case0"
+printf 'ASINACOSCOSH\x01\xce\xb5?\n' >> "$WORK/case0"
+awk 'BEGIN {
+    split("1|23|0.5|3.14159|123456789012345678901234567890.5|00012.000|1.|.5| |\t|   |\n|+|-|(|)|exit|quit|SINH|COSH|ASIN|ACOS|exi|SIN|x|#|e|A|q", piece, "|");
+    srand(7);
+    for (c = 1; c <= 200; c++) {
+        file = sprintf("'"$WORK"'/case%d", c);
+        n = int(rand() * 200);
+        for (i = 0; i < n; i++) printf "%s", piece[int(rand() * 30) + 1] > file;
+        close(file);
+    }
+}'
+awk -v lines="$LINES" 'BEGIN {
+    srand(3);
+    for (l = 0; l < lines; l++) {
+        for (k = 0; k < 8; k++) {
+            r = int(rand() * 4);
+            if (r == 0) printf "%d", int(rand() * 1000000);
+            else if (r == 1) printf "%.4f", rand() * 1000;
+            else if (r == 2) printf "SINH(%d.5)", int(rand() * 9);
+            else printf "( 1 - 2 )";
+            printf (k < 7 ? " + " : "\n");
+        }
+    }
+}' > "$WORK/bench"
+
+if [ -x "$WORK/driver_flex" ]; then
+    failed=0
+    for f in "$WORK"/case*; do
+        "$WORK/driver_flex" < "$f" > "$WORK/out_flex"
+        "$WORK/driver_hand" < "$f" > "$WORK/out_hand"
+        if ! cmp -s "$WORK/out_flex" "$WORK/out_hand"; then
+            echo "token streams differ for input $(basename "$f"):"
+            diff "$WORK/out_flex" "$WORK/out_hand" | head -10
+            failed=1
+        fi
+    done
+    [ $failed -eq 0 ] || exit 1
+    echo "token streams identical on $(ls "$WORK"/case* | wc -l) inputs"
+    printf 'flex scanner:         '
+    "$WORK/driver_flex" -b < "$WORK/bench"
+fi
+printf 'hand-written scanner: '
+"$WORK/driver_hand" -b < "$WORK/bench"
@@ -0,0 +1,131 @@
+// Benchmark of the SCC-ordered FIRST/FOLLOW solver on wide, shallow grammars.
+//
+//     gcc -O2 bench_scc.c first_follow.c -o bench_scc
+//     ./bench_scc [iterations]
+//
+// Each grammar has 13 leaf non-terminals (N..Z) that derive terminals or ε,
+// 12 middle non-terminals (B..M) built from leaves, and S -> B | ... | M.
+// So the condensation has many independent SCCs on very few levels. Every
+// run is checked against a plain whole-grammar fixpoint, and both are timed.
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "first_follow.h"
+
+void make_wide_grammar(unsigned int seed) {
+    const char terminals[] = "abcdfghijklmnopqrstuvwxyz()+*";  // no 'e', that is ε
+    srand(seed);
+    reset_grammar();
+    start_symbol = 'S';
+
+    for (char L = 'N'; L <= 'Z'; L++) {
+        char rhs[2] = {terminals[rand() % (sizeof(terminals) - 1)], '\0'};
+        add_production(L, rhs);
+        if (rand() % 3 == 0)
+            add_production(L, "e");
+    }
+    for (char M = 'B'; M <= 'M'; M++) {
+        for (int alt = 0; alt < 2; alt++) {
+            char rhs[4];
+            int n = 2 + rand() % 2;
+            for (int j = 0; j < n; j++)
+                rhs[j] = rand() % 4 ? 'N' + rand() % 13 : terminals[rand() % 20];
+            rhs[n] = '\0';
+            add_production(M, rhs);
+        }
+    }
+    for (char M = 'B'; M <= 'M'; M++) {
+        char rhs[2] = {M, '\0'};
+        add_production('S', rhs);
+    }
+}
+
+// Reference: apply every rule to every non-terminal until nothing changes
+void naive_fixpoint() {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < 26; i++)
+            if (defined[i] && first_step('A' + i))
+                changed = true;
+    }
+    changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < 26; i++)
+            if (defined[i] && follow_step('A' + i))
+                changed = true;
+    }
+}
+
+bool same_set(char *a, int na, char *b, int nb) {
+    if (na != nb)
+        return false;
+    for (int i = 0; i < na; i++)
+        if (!is_in_set(a[i], b, nb))
+            return false;
+    return true;
+}
+
+double seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    double scc_time = 0, naive_time = 0;
+    int widest = 0, levels = 0;
+
+    for (int it = 0; it < iterations; it++) {
+        make_wide_grammar(it);
+
+        double t0 = seconds();
+        reset_sets();
+        compute_sets();
+        double t1 = seconds();
+        scc_time += t1 - t0;
+
+        char first_scc[26][MAX_GRAMMAR_SIZE], follow_scc[26][MAX_GRAMMAR_SIZE];
+        int first_n[26], follow_n[26];
+        memcpy(first_scc, first, sizeof(first));
+        memcpy(follow_scc, follow, sizeof(follow));
+        memcpy(first_n, first_size, sizeof(first_size));
+        memcpy(follow_n, follow_size, sizeof(follow_size));
+        // num_sccs/scc_level describe the FOLLOW graph, the last one solved
+        if (num_levels > levels)
+            levels = num_levels;
+        for (int lv = 0; lv < num_levels; lv++) {
+            int width = 0;
+            for (int c = 0; c < num_sccs; c++)
+                if (scc_level[c] == lv)
+                    width++;
+            if (width > widest)
+                widest = width;
+        }
+
+        t0 = seconds();
+        reset_sets();
+        naive_fixpoint();
+        naive_time += seconds() - t0;
+
+        for (int i = 0; i < 26; i++) {
+            if (!same_set(first_scc[i], first_n[i], first[i], first_size[i])
+                || !same_set(follow_scc[i], follow_n[i], follow[i], follow_size[i])) {
+                printf("MISMATCH in grammar %d at %c\n", it, 'A' + i);
+                return 1;
+            }
+        }
+    }
+
+    printf("%d grammars, %d productions in the last, FOLLOW graph: up to %d levels, widest level %d SCCs\n",
+           iterations, num_productions, levels, widest);
+    printf("SCC order:       %.2f us per grammar\n", scc_time / iterations * 1e6);
+    printf("Whole fixpoint:  %.2f us per grammar\n", naive_time / iterations * 1e6);
+    return 0;
+}
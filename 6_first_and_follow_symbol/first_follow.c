@@ -0,0 +1,317 @@
+#include <string.h>
+#include <ctype.h>
+#include "first_follow.h"
+
+Production grammar[MAX_GRAMMAR_SIZE];
+int num_productions = 0;
+char start_symbol;
+
+// Sets for FIRST and FOLLOW
+char first[26][MAX_GRAMMAR_SIZE];  // Array for each uppercase letter (A-Z)
+char follow[26][MAX_GRAMMAR_SIZE]; 
+int first_size[26] = {0};
+int follow_size[26] = {0};
+bool defined[26] = {false};  // Non-terminals that have at least one production
+
+// Dependency graphs between non-terminals: dep[X][Y] means the set of X
+// needs the set of Y. The graph is condensed into SCCs and each SCC gets a
+// topological level: level 0 needs no other SCC, level n only needs SCCs
+// below n. Levels are solved in order, so every SCC sees its dependencies
+// finished, and the SCCs within one level are independent of each other.
+bool first_dep[26][26];
+bool follow_dep[26][26];
+
+int scc_of[26];          // SCC id of each non-terminal
+int scc_level[26];       // Topological level of each SCC
+int scc_members[26];     // Non-terminals grouped by SCC...
+int scc_start[27];       // ...SCC c is scc_members[scc_start[c] .. scc_start[c+1])
+int num_sccs, num_levels;
+
+static void solve_in_scc_order(bool dep[26][26], bool (*step)(char));
+
+// Add production to the grammar
+void add_production(char lhs, const char* rhs) {
+    defined[lhs - 'A'] = true;
+    grammar[num_productions].lhs = lhs;
+    grammar[num_productions].length = strlen(rhs);
+    strcpy(grammar[num_productions].rhs, rhs);
+    num_productions++;
+}
+
+// Check if a character c is in set
+bool is_in_set(char c, char* set, int set_size) {
+    for (int i = 0; i < set_size; i++) {
+        if (set[i] == c)
+            return true;
+    }
+    return false;
+}
+
+// Add c to set if not already present
+void add_to_set(char c, char* set, int* set_size) {
+    if (!is_in_set(c, set, *set_size)) {
+        set[(*set_size)++] = c;
+    }
+}
+
+// Add all elements from source_set to dest_set
+void union_sets(char* source_set, int source_size, char* dest_set, int* dest_size) {
+    for (int i = 0; i < source_size; i++) {
+        add_to_set(source_set[i], dest_set, dest_size);
+    }
+}
+
+// Check if epsilon is in the first set of X
+bool has_epsilon(char X) {
+    int idx = X - 'A';
+    return is_in_set('e', first[idx], first_size[idx]);
+}
+
+// Check if c is a terminal symbol of the grammar: anything but a
+// non-terminal (A-Z) or 'e', which stands for epsilon
+bool is_terminal(char c) {
+    return !isupper(c) && c != 'e';
+}
+// Build both dependency graphs and solve FIRST, then FOLLOW
+void compute_sets() {
+    // FIRST(X) depends on FIRST(Y) for every non-terminal Y in X's productions
+    for (int i = 0; i < num_productions; i++) {
+        for (int j = 0; j < grammar[i].length; j++) {
+            if (isupper(grammar[i].rhs[j]))
+                first_dep[grammar[i].lhs - 'A'][grammar[i].rhs[j] - 'A'] = true;
+        }
+    }
+    solve_in_scc_order(first_dep, first_step);
+    
+    // FOLLOW(X) depends on FOLLOW(A) for A -> αX and A -> αXB with ε in FIRST(B)
+    for (int i = 0; i < num_productions; i++) {
+        char A = grammar[i].lhs;
+        for (int j = 0; j < grammar[i].length; j++) {
+            char X = grammar[i].rhs[j];
+            if (!isupper(X))
+                continue;
+            if (j == grammar[i].length - 1) {
+                if (A != X)
+                    follow_dep[X - 'A'][A - 'A'] = true;
+            } else if (isupper(grammar[i].rhs[j+1]) && has_epsilon(grammar[i].rhs[j+1])) {
+                follow_dep[X - 'A'][A - 'A'] = true;
+            }
+        }
+    }
+    solve_in_scc_order(follow_dep, follow_step);
+}
+
+// Clear the computed sets and dependency graphs, keeping the grammar
+void reset_sets() {
+    memset(first_size, 0, sizeof(first_size));
+    memset(follow_size, 0, sizeof(follow_size));
+    memset(first_dep, 0, sizeof(first_dep));
+    memset(follow_dep, 0, sizeof(follow_dep));
+}
+
+// Clear the grammar as well
+void reset_grammar() {
+    num_productions = 0;
+    memset(defined, 0, sizeof(defined));
+    reset_sets();
+}
+
+// Tarjan state for solve_in_scc_order
+static int scc_index[26], scc_low[26], scc_stack[26], scc_top, scc_counter;
+static bool scc_on_stack[26];
+
+// Iterate step over the members of SCC c until none of their sets change
+static void solve_scc(int c, bool (*step)(char)) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int k = scc_start[c]; k < scc_start[c + 1]; k++) {
+            if (step('A' + scc_members[k]))
+                changed = true;
+        }
+    }
+}
+
+static void strong_connect(int v, bool dep[26][26]) {
+    scc_index[v] = scc_low[v] = scc_counter++;
+    scc_stack[scc_top++] = v;
+    scc_on_stack[v] = true;
+    
+    for (int w = 0; w < 26; w++) {
+        if (!dep[v][w] || !defined[w])
+            continue;
+        if (scc_index[w] == -1) {
+            strong_connect(w, dep);
+            if (scc_low[w] < scc_low[v])
+                scc_low[v] = scc_low[w];
+        } else if (scc_on_stack[w] && scc_index[w] < scc_low[v]) {
+            scc_low[v] = scc_index[w];
+        }
+    }
+    
+    // v is the root of an SCC. Tarjan emits SCCs in reverse topological
+    // order, so every SCC this one depends on already has a smaller id.
+    if (scc_low[v] == scc_index[v]) {
+        int c = num_sccs++;
+        int n = scc_start[c];
+        do {
+            int w = scc_stack[--scc_top];
+            scc_on_stack[w] = false;
+            scc_of[w] = c;
+            scc_members[n++] = w;
+        } while (scc_members[n - 1] != v);
+        scc_start[c + 1] = n;
+    }
+}
+
+// Solve one family of sets over the condensation of its dependency graph
+static void solve_in_scc_order(bool dep[26][26], bool (*step)(char)) {
+    scc_top = scc_counter = num_sccs = num_levels = 0;
+    scc_start[0] = 0;
+    for (int i = 0; i < 26; i++) {
+        scc_index[i] = -1;
+        scc_on_stack[i] = false;
+    }
+    // Visit in production order so set contents come out in a stable order
+    for (int i = 0; i < num_productions; i++) {
+        int v = grammar[i].lhs - 'A';
+        if (scc_index[v] == -1)
+            strong_connect(v, dep);
+    }
+    
+    // Level of an SCC = 1 + highest level among the SCCs it depends on.
+    // Dependencies have smaller ids, so one pass in id order is enough.
+    for (int c = 0; c < num_sccs; c++) {
+        scc_level[c] = 0;
+        for (int k = scc_start[c]; k < scc_start[c + 1]; k++) {
+            int v = scc_members[k];
+            for (int w = 0; w < 26; w++) {
+                if (dep[v][w] && defined[w] && scc_of[w] != c
+                    && scc_level[scc_of[w]] + 1 > scc_level[c])
+                    scc_level[c] = scc_level[scc_of[w]] + 1;
+            }
+        }
+        if (scc_level[c] + 1 > num_levels)
+            num_levels = scc_level[c] + 1;
+    }
+    
+    // The SCCs within one level do not read each other's sets, so this
+    // inner loop is where they could be handed to separate workers.
+    for (int level = 0; level < num_levels; level++) {
+        for (int c = 0; c < num_sccs; c++) {
+            if (scc_level[c] == level)
+                solve_scc(c, step);
+        }
+    }
+}
+
+// Apply the FIRST rules of every production of X once.
+// Returns true if FIRST(X) grew.
+bool first_step(char X) {
+    int idx = X - 'A';
+    int old_size = first_size[idx];
+    
+    // Go through all productions where X is on the LHS
+    for (int i = 0; i < num_productions; i++) {
+        if (grammar[i].lhs == X) {
+            // Case 1: X -> ε
+            if (grammar[i].length == 1 && grammar[i].rhs[0] == 'e') {
+                add_to_set('e', first[idx], &first_size[idx]);
+            } 
+            // Case 2: X -> Y...
+            else {
+                bool added_epsilon = true;
+                
+                // Process each symbol in the right-hand side
+                for (int j = 0; j < grammar[i].length; j++) {
+                    char Y = grammar[i].rhs[j];
+                    
+                    // If terminal, add to FIRST(X) and break
+                    if (is_terminal(Y)) {
+                        add_to_set(Y, first[idx], &first_size[idx]);
+                        added_epsilon = false;
+                        break;
+                    }
+                    // If non-terminal, add FIRST(Y) to FIRST(X)
+                    else if (isupper(Y)) {
+                        int Y_idx = Y - 'A';
+                        
+                        // Add all except epsilon from FIRST(Y) to FIRST(X)
+                        for (int k = 0; k < first_size[Y_idx]; k++) {
+                            if (first[Y_idx][k] != 'e') {
+                                add_to_set(first[Y_idx][k], first[idx], &first_size[idx]);
+                            }
+                        }
+                        
+                        // If no epsilon in FIRST(Y), break
+                        if (!has_epsilon(Y)) {
+                            added_epsilon = false;
+                            break;
+                        }
+                    }
+                }
+                
+                // If we went through all symbols and they all have epsilon,
+                // add epsilon to FIRST(X)
+                if (added_epsilon) {
+                    add_to_set('e', first[idx], &first_size[idx]);
+                }
+            }
+        }
+    }
+    
+    return first_size[idx] != old_size;
+}
+
+// Apply the FOLLOW rules for every occurrence of X once.
+// Returns true if FOLLOW(X) grew.
+bool follow_step(char X) {
+    int idx = X - 'A';
+    int old_size = follow_size[idx];
+    
+    // For start symbol, add $ to FOLLOW set
+    if (X == start_symbol) {
+        add_to_set('$', follow[idx], &follow_size[idx]);
+    }
+    
+    // For each production
+    for (int i = 0; i < num_productions; i++) {
+        int lhs_idx = grammar[i].lhs - 'A';
+        
+        // Find X in RHS of the production
+        for (int j = 0; j < grammar[i].length; j++) {
+            if (grammar[i].rhs[j] == X) {
+                // Case 1: A -> αXβ, add FIRST(β) to FOLLOW(X)
+                if (j < grammar[i].length - 1) {
+                    char beta = grammar[i].rhs[j+1];
+                    
+                    if (is_terminal(beta)) {
+                        add_to_set(beta, follow[idx], &follow_size[idx]);
+                    } else if (isupper(beta)) {
+                        int beta_idx = beta - 'A';
+                            
+                        // Add all except epsilon
+                        for (int k = 0; k < first_size[beta_idx]; k++) {
+                            if (first[beta_idx][k] != 'e') {
+                                add_to_set(first[beta_idx][k], follow[idx], &follow_size[idx]);
+                            }
+                        }
+                        
+                        // If epsilon in FIRST(β), add FOLLOW(A) to FOLLOW(X)
+                        if (has_epsilon(beta)) {
+                            union_sets(follow[lhs_idx], follow_size[lhs_idx],
+                                      follow[idx], &follow_size[idx]);
+                        }
+                    }
+                }
+                // Case 2: A -> αX, add FOLLOW(A) to FOLLOW(X)
+                else if (grammar[i].lhs != X) {
+                    union_sets(follow[lhs_idx], follow_size[lhs_idx],
+                              follow[idx], &follow_size[idx]);
+                }
+            }
+        }
+    }
+    
+    return follow_size[idx] != old_size;
+}
@@ -0,0 +1,55 @@
+#ifndef FIRST_FOLLOW_H
+#define FIRST_FOLLOW_H
+
+#include <stdbool.h>
+
+// FIRST/FOLLOW analysis over single-character grammars: non-terminals are
+// the uppercase letters, 'e' stands for epsilon and every other character
+// is a terminal. main.c is the command line tool around it; bench_scc.c
+// links the same code.
+
+#define MAX_GRAMMAR_SIZE 64
+#define MAX_SYMBOL_LENGTH 10
+
+// Grammar representation using simple arrays
+typedef struct {
+    char lhs;
+    char rhs[20];
+    int length;
+} Production;
+
+extern Production grammar[MAX_GRAMMAR_SIZE];
+extern int num_productions;
+extern char start_symbol;
+
+// Sets for FIRST and FOLLOW, indexed by non-terminal (A-Z)
+extern char first[26][MAX_GRAMMAR_SIZE];
+extern char follow[26][MAX_GRAMMAR_SIZE];
+extern int first_size[26];
+extern int follow_size[26];
+extern bool defined[26];  // Non-terminals that have at least one production
+
+// Dependency graphs and their condensation, see first_follow.c
+extern bool first_dep[26][26];
+extern bool follow_dep[26][26];
+extern int scc_of[26], scc_level[26], scc_members[26], scc_start[27];
+extern int num_sccs, num_levels;
+
+void add_production(char lhs, const char* rhs);
+bool is_in_set(char c, char* set, int set_size);
+bool has_epsilon(char X);
+bool is_terminal(char c);
+
+// Apply the rules for X once; true if its set grew
+bool first_step(char X);
+bool follow_step(char X);
+
+// Build the dependency graphs and solve FIRST, then FOLLOW
+void compute_sets();
+
+// Clear the computed sets and dependency graphs, keeping the grammar
+void reset_sets();
+// Clear the grammar as well
+void reset_grammar();
+
+#endif
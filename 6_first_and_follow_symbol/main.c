@@ -1,68 +1,31 @@
+// FIRST and FOLLOW sets of a grammar, cached per grammar on disk.
+//
+//     gcc main.c first_follow.c ../common/grammar.c -o first_follow
+//     ./first_follow [grammar.txt]
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <unistd.h>
+#include "../common/grammar.h"
+#include "first_follow.h"
 
-#define MAX_GRAMMAR_SIZE 20
-#define MAX_SYMBOL_LENGTH 10
-
-// Grammar representation using simple arrays
+#define CACHE_FILE "first_follow-%016llx.cache"  // one file per grammar hash
+#define CACHE_MAGIC 0x31434646u  // "FFC1"
+#define CACHE_VERSION 3
+// On-disk cache of the computed sets. The layout is fixed-size and flat
+// (no pointers), so the file can be read in one go or mmap'd directly.
 typedef struct {
-    char lhs;
-    char rhs[20];
-    int length;
-} Production;
-
-Production grammar[MAX_GRAMMAR_SIZE];
-int num_productions = 0;
-char start_symbol;
-
-// Sets for FIRST and FOLLOW
-char first[26][MAX_GRAMMAR_SIZE];  // Array for each uppercase letter (A-Z)
-char follow[26][MAX_GRAMMAR_SIZE]; 
-int first_size[26] = {0};
-int follow_size[26] = {0};
-bool first_computed[26] = {false};
-bool follow_computed[26] = {false};
-
-// Add production to the grammar
-void add_production(char lhs, const char* rhs) {
-    grammar[num_productions].lhs = lhs;
-    grammar[num_productions].length = strlen(rhs);
-    strcpy(grammar[num_productions].rhs, rhs);
-    num_productions++;
-}
-
-// Check if a character c is in set
-bool is_in_set(char c, char* set, int set_size) {
-    for (int i = 0; i < set_size; i++) {
-        if (set[i] == c)
-            return true;
-    }
-    return false;
-}
-
-// Add c to set if not already present
-void add_to_set(char c, char* set, int* set_size) {
-    if (!is_in_set(c, set, *set_size)) {
-        set[(*set_size)++] = c;
-    }
-}
-
-// Add all elements from source_set to dest_set
-void union_sets(char* source_set, int source_size, char* dest_set, int* dest_size) {
-    for (int i = 0; i < source_size; i++) {
-        add_to_set(source_set[i], dest_set, dest_size);
-    }
-}
-
-// Check if epsilon is in the first set of X
-bool has_epsilon(char X) {
-    int idx = X - 'A';
-    return is_in_set('e', first[idx], first_size[idx]);
-}
-
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long grammar_hash;
+    char first[26][MAX_GRAMMAR_SIZE];
+    char follow[26][MAX_GRAMMAR_SIZE];
+    int first_size[26];
+    int follow_size[26];
+} AnalysisCache;
 // Print sets
 void print_sets() {
     printf("FIRST SETS:\n");
@@ -92,157 +55,138 @@ void print_sets() {
     }
 }
 
-int main() {
-    // Simple grammar:
-    // S -> A B
-    // A -> a | e
-    // B -> b
-    add_production('S', "AB");
-    add_production('A', "a");
-    add_production('A', "e");  // e represents epsilon
-    add_production('B', "b");
-    
-    start_symbol = 'S';
-    
-    // Calculate FIRST for all non-terminals
+// FNV-1a hash over the start symbol and every production, in order
+unsigned long long grammar_hash() {
+    unsigned long long h = 1469598103934665603ULL;
+    h = (h ^ (unsigned char)start_symbol) * 1099511628211ULL;
     for (int i = 0; i < num_productions; i++) {
-        char nt = grammar[i].lhs;
-        if (!first_computed[nt - 'A'])
-            compute_first(nt);
+        h = (h ^ (unsigned char)grammar[i].lhs) * 1099511628211ULL;
+        for (int j = 0; j < grammar[i].length; j++)
+            h = (h ^ (unsigned char)grammar[i].rhs[j]) * 1099511628211ULL;
+        h = (h ^ '\n') * 1099511628211ULL;  // production separator
     }
-    
-    // Calculate FOLLOW for all non-terminals
-    for (int i = 0; i < num_productions; i++) {
-        char nt = grammar[i].lhs;
-        if (!follow_computed[nt - 'A'])
-            compute_follow(nt);
+    return h;
+}
+
+// Load FIRST and FOLLOW from the cache file if it matches this grammar.
+// Returns true on a hit; on any mismatch the sets are left untouched.
+bool load_cache(unsigned long long hash) {
+    AnalysisCache cache;
+    char path[64];
+    snprintf(path, sizeof(path), CACHE_FILE, hash);
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+        return false;
+    size_t n = fread(&cache, sizeof(cache), 1, fp);
+    fclose(fp);
+
+    if (n != 1 || cache.magic != CACHE_MAGIC || cache.version != CACHE_VERSION
+        || cache.grammar_hash != hash)
+        return false;
+
+    // Sizes are used as loop bounds, so a damaged file counts as a miss
+    for (int i = 0; i < 26; i++) {
+        if (cache.first_size[i] < 0 || cache.first_size[i] > MAX_GRAMMAR_SIZE
+            || cache.follow_size[i] < 0 || cache.follow_size[i] > MAX_GRAMMAR_SIZE)
+            return false;
     }
-    
-    // Print results
-    print_sets();
-    
-    return 0;
+
+    memcpy(first, cache.first, sizeof(first));
+    memcpy(follow, cache.follow, sizeof(follow));
+    memcpy(first_size, cache.first_size, sizeof(first_size));
+    memcpy(follow_size, cache.follow_size, sizeof(follow_size));
+    return true;
 }
 
-// Calculate FIRST set for a non-terminal
-void compute_first(char X) {
-    int idx = X - 'A';
-    
-    // If already calculated
-    if (first_computed[idx])
+// Write the computed sets to the cache file. A temporary file is renamed
+// into place so a concurrent reader never sees a half-written cache.
+void save_cache(unsigned long long hash) {
+    AnalysisCache cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = CACHE_MAGIC;
+    cache.version = CACHE_VERSION;
+    cache.grammar_hash = hash;
+    memcpy(cache.first, first, sizeof(first));
+    memcpy(cache.follow, follow, sizeof(follow));
+    memcpy(cache.first_size, first_size, sizeof(first_size));
+    memcpy(cache.follow_size, follow_size, sizeof(follow_size));
+
+    // The temp name is unique per process so parallel writers never share a file
+    char path[64], tmp[80];
+    snprintf(path, sizeof(path), CACHE_FILE, hash);
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+    FILE *fp = fopen(tmp, "wb");
+    if (fp == NULL)
+        return;  // caching is best-effort
+    size_t n = fwrite(&cache, sizeof(cache), 1, fp);
+    if (fclose(fp) != 0 || n != 1) {
+        remove(tmp);
         return;
-    
-    first_computed[idx] = true;
-    
-    // Go through all productions where X is on the LHS
-    for (int i = 0; i < num_productions; i++) {
-        if (grammar[i].lhs == X) {
-            // Case 1: X -> ε
-            if (grammar[i].length == 1 && grammar[i].rhs[0] == 'e') {
-                add_to_set('e', first[idx], &first_size[idx]);
-            } 
-            // Case 2: X -> Y...
-            else {
-                bool added_epsilon = true;
-                
-                // Process each symbol in the right-hand side
-                for (int j = 0; j < grammar[i].length; j++) {
-                    char Y = grammar[i].rhs[j];
-                    
-                    // If terminal, add to FIRST(X) and break
-                    if (islower(Y) || Y == '(' || Y == ')' || Y == '$' || Y == '+' || Y == '*') {
-                        add_to_set(Y, first[idx], &first_size[idx]);
-                        added_epsilon = false;
-                        break;
-                    }
-                    // If non-terminal, compute FIRST(Y) and add to FIRST(X)
-                    else if (isupper(Y)) {
-                        compute_first(Y);
-                        int Y_idx = Y - 'A';
-                        
-                        // Add all except epsilon from FIRST(Y) to FIRST(X)
-                        for (int k = 0; k < first_size[Y_idx]; k++) {
-                            if (first[Y_idx][k] != 'e') {
-                                add_to_set(first[Y_idx][k], first[idx], &first_size[idx]);
-                            }
-                        }
-                        
-                        // If no epsilon in FIRST(Y), break
-                        if (!has_epsilon(Y)) {
-                            added_epsilon = false;
-                            break;
-                        }
-                    }
-                }
-                
-                // If we went through all symbols and they all have epsilon,
-                // add epsilon to FIRST(X)
-                if (added_epsilon) {
-                    add_to_set('e', first[idx], &first_size[idx]);
+    }
+    rename(tmp, path);
+}
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        // Read the grammar from a file; the start symbol is the first LHS
+        char rows[MAX_GRAMMAR_SIZE][sizeof(grammar[0].rhs) + 3];
+        int n = grammar_load_productions(argv[1], rows[0], MAX_GRAMMAR_SIZE, sizeof(rows[0]), 1);
+        if (n == -1)
+            return 1;
+        for (int i = 0; i < n; i++) {
+            if (!isupper(rows[i][0])) {
+                fprintf(stderr, "%s: non-terminal '%c' must be an uppercase letter\n", argv[1], rows[i][0]);
+                return 1;
+            }
+            if (strchr(rows[i] + 3, 'e')) {
+                fprintf(stderr, "%s: 'e' is reserved for ε, rename the terminal\n", argv[1]);
+                return 1;
+            }
+            // An ε-production comes back as "A->"; here ε is written 'e'
+            add_production(rows[i][0], rows[i][3] ? rows[i] + 3 : "e");
+        }
+        // A set holds terminals plus 'e' or '$'
+        bool seen[256] = {false};
+        int terminals = 0;
+        for (int i = 0; i < num_productions; i++) {
+            for (int j = 0; j < grammar[i].length; j++) {
+                unsigned char c = grammar[i].rhs[j];
+                if (is_terminal(c) && !seen[c]) {
+                    seen[c] = true;
+                    terminals++;
                 }
             }
         }
+        if (terminals > MAX_GRAMMAR_SIZE - 2) {
+            fprintf(stderr, "%s: %d terminals, at most %d supported\n", argv[1], terminals, MAX_GRAMMAR_SIZE - 2);
+            return 1;
+        }
+        start_symbol = rows[0][0];
+    } else {
+        // Simple grammar:
+        // S -> A B
+        // A -> a | e
+        // B -> b
+        add_production('S', "AB");
+        add_production('A', "a");
+        add_production('A', "e");  // e represents epsilon
+        add_production('B', "b");
+        
+        start_symbol = 'S';
     }
-}
-
-// Calculate FOLLOW set for a non-terminal
-void compute_follow(char X) {
-    int idx = X - 'A';
     
-    // If already calculated
-    if (follow_computed[idx])
-        return;
+    // Skip the analysis entirely if a cache for this grammar exists
+    unsigned long long hash = grammar_hash();
+    if (load_cache(hash)) {
+        print_sets();
+        return 0;
+    }
     
-    follow_computed[idx] = true;
+    compute_sets();
     
-    // For start symbol, add $ to FOLLOW set
-    if (X == start_symbol) {
-        add_to_set('$', follow[idx], &follow_size[idx]);
-    }
+    save_cache(hash);
     
-    // For each production
-    for (int i = 0; i < num_productions; i++) {
-        // Find X in RHS of the production
-        for (int j = 0; j < grammar[i].length; j++) {
-            if (grammar[i].rhs[j] == X) {
-                // Case 1: A -> αXβ, add FIRST(β) to FOLLOW(X)
-                if (j < grammar[i].length - 1) {
-                    char beta = grammar[i].rhs[j+1];
-                    
-                    if (islower(beta) || beta == '(' || beta == ')' || beta == '$' || beta == '+' || beta == '*') {
-                        add_to_set(beta, follow[idx], &follow_size[idx]);
-                    } else if (isupper(beta)) {
-                        int beta_idx = beta - 'A';
-                        if (!first_computed[beta_idx])
-                            compute_first(beta);
-                            
-                        // Add all except epsilon
-                        for (int k = 0; k < first_size[beta_idx]; k++) {
-                            if (first[beta_idx][k] != 'e') {
-                                add_to_set(first[beta_idx][k], follow[idx], &follow_size[idx]);
-                            }
-                        }
-                        
-                        // If epsilon in FIRST(β), add FOLLOW(A) to FOLLOW(X)
-                        if (has_epsilon(beta)) {
-                            compute_follow(grammar[i].lhs);
-                            union_sets(follow[grammar[i].lhs - 'A'], 
-                                      follow_size[grammar[i].lhs - 'A'], 
-                                      follow[idx], 
-                                      &follow_size[idx]);
-                        }
-                    }
-                }
-                // Case 2: A -> αX, add FOLLOW(A) to FOLLOW(X)
-                else if (j == grammar[i].length - 1 && grammar[i].lhs != X) {
-                    compute_follow(grammar[i].lhs);
-                    union_sets(follow[grammar[i].lhs - 'A'], 
-                              follow_size[grammar[i].lhs - 'A'], 
-                              follow[idx], 
-                              &follow_size[idx]);
-                }
-            }
-        }
-    }
+    // Print results
+    print_sets();
+    
+    return 0;
 }
-
@@ -0,0 +1,430 @@
+#include <string.h>
+#include <ctype.h>
+#include "follow.h"
+
+int num_productions = 0;
+struct Production grammar[MAX_PROD];
+
+char first[256][MAX_SYMBOLS] = {0};
+char follow[256][MAX_SYMBOLS] = {0};
+char start_symbol = 'E';
+
+int is_terminal(char c) {
+    return !(isupper(c) || c == 'e' || c == 't');
+}
+
+int count_terminals(const char *extra) {
+    char seen[256] = {0};
+    int count = 0;
+    for (int i = 0; i <= num_productions; i++) {
+        const char *p = i < num_productions ? grammar[i].rhs : extra;
+        for (; *p; p++) {
+            unsigned char c = *p;
+            if (is_terminal(c) && !seen[c]) {
+                seen[c] = 1;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static void add_char(char *set, char c) {
+    if (c == '\0') return;
+    if (!strchr(set, c)) {
+        int len = strlen(set);
+        set[len] = c;
+        set[len + 1] = '\0';
+    }
+}
+
+static void compute_string_first(char *beta, char *result) {
+    result[0] = '\0';
+    int can_derive_epsilon = 1;
+
+    for (int i = 0; beta[i] != '\0' && can_derive_epsilon; i++) {
+        char symbol = beta[i];
+        if (is_terminal(symbol)) {
+            add_char(result, symbol);
+            can_derive_epsilon = 0;
+            break;
+        } else {
+            char *fs = first[symbol];
+            for (int j = 0; fs[j] != '\0'; j++) {
+                if (fs[j] != EPSILON) {
+                    add_char(result, fs[j]);
+                }
+            }
+            if (!strchr(fs, EPSILON)) {
+                can_derive_epsilon = 0;
+            }
+        }
+    }
+
+    if (can_derive_epsilon) {
+        add_char(result, EPSILON);
+    }
+}
+
+void compute_first() {
+    int changes;
+    do {
+        changes = 0;
+        for (int i = 0; i < num_productions; i++) {
+            char lhs = grammar[i].lhs;
+            char *rhs = grammar[i].rhs;
+
+            char current_first[MAX_SYMBOLS];
+            strcpy(current_first, first[lhs]);
+
+            int can_derive_epsilon = 1;
+            for (int j = 0; rhs[j] != '\0' && can_derive_epsilon; j++) {
+                char symbol = rhs[j];
+                if (is_terminal(symbol)) {
+                    add_char(first[lhs], symbol);
+                    can_derive_epsilon = 0;
+                    break;
+                } else {
+                    char *fs = first[symbol];
+                    for (int k = 0; fs[k] != '\0'; k++) {
+                        if (fs[k] != EPSILON) {
+                            add_char(first[lhs], fs[k]);
+                        }
+                    }
+                    if (!strchr(fs, EPSILON)) {
+                        can_derive_epsilon = 0;
+                    }
+                }
+            }
+            if (can_derive_epsilon) {
+                add_char(first[lhs], EPSILON);
+            }
+
+            if (strcmp(current_first, first[lhs]) != 0) {
+                changes = 1;
+            }
+        }
+    } while (changes);
+}
+
+void compute_follow() {
+    add_char(follow[(unsigned char)start_symbol], '$');
+
+    int changes;
+    do {
+        changes = 0;
+        for (int i = 0; i < num_productions; i++) {
+            char A = grammar[i].lhs;
+            char *alpha = grammar[i].rhs;
+
+            for (int j = 0; alpha[j] != '\0'; j++) {
+                char B = alpha[j];
+                if (is_terminal(B)) continue;
+
+                char beta[MAX_SYMBOLS];
+                strcpy(beta, alpha + j + 1);
+
+                char first_beta[MAX_SYMBOLS] = {0};
+                compute_string_first(beta, first_beta);
+
+                for (int k = 0; first_beta[k] != '\0'; k++) {
+                    if (first_beta[k] != EPSILON) {
+                        if (!strchr(follow[B], first_beta[k])) {
+                            add_char(follow[B], first_beta[k]);
+                            changes = 1;
+                        }
+                    }
+                }
+
+                if (strchr(first_beta, EPSILON)) {
+                    char *follow_A = follow[A];
+                    for (int k = 0; follow_A[k] != '\0'; k++) {
+                        if (!strchr(follow[B], follow_A[k])) {
+                            add_char(follow[B], follow_A[k]);
+                            changes = 1;
+                        }
+                    }
+                }
+            }
+        }
+    } while (changes);
+}
+
+/*
+ * Incremental maintenance: add_production() and remove_production() edit
+ * the grammar and update FIRST/FOLLOW without starting over. Only the
+ * non-terminals an edit can reach are re-propagated. Additions only grow
+ * sets, so they are pushed forward with a worklist. Removals use
+ * delete-and-rederive: every set that may depend on the removed
+ * production is cleared, then rebuilt from the remaining productions.
+ */
+
+static int occurs_in(int i, char X) {
+    return strchr(grammar[i].rhs, X) != NULL;
+}
+
+// Apply the FIRST rule of production i; returns 1 if FIRST(lhs) grew
+static int apply_first_rule(int i) {
+    unsigned char lhs = grammar[i].lhs;
+    char *rhs = grammar[i].rhs;
+    int before = strlen(first[lhs]);
+
+    int can_derive_epsilon = 1;
+    for (int j = 0; rhs[j] != '\0' && can_derive_epsilon; j++) {
+        unsigned char symbol = rhs[j];
+        char *fs = first[symbol];
+        for (int k = 0; fs[k] != '\0'; k++) {
+            if (fs[k] != EPSILON) {
+                add_char(first[lhs], fs[k]);
+            }
+        }
+        if (!strchr(fs, EPSILON)) {
+            can_derive_epsilon = 0;
+        }
+    }
+    if (can_derive_epsilon) {
+        add_char(first[lhs], EPSILON);
+    }
+
+    return (int)strlen(first[lhs]) != before;
+}
+
+// Apply every FOLLOW rule whose target is B; returns 1 if FOLLOW(B) grew
+static int apply_follow_rules(char B) {
+    unsigned char b = B;
+    int before = strlen(follow[b]);
+
+    if (B == start_symbol) {
+        add_char(follow[b], '$');
+    }
+    for (int i = 0; i < num_productions; i++) {
+        char *alpha = grammar[i].rhs;
+        for (int j = 0; alpha[j] != '\0'; j++) {
+            if (alpha[j] != B) continue;
+
+            char first_beta[MAX_SYMBOLS] = {0};
+            compute_string_first(alpha + j + 1, first_beta);
+            for (int k = 0; first_beta[k] != '\0'; k++) {
+                if (first_beta[k] != EPSILON) {
+                    add_char(follow[b], first_beta[k]);
+                }
+            }
+            if (strchr(first_beta, EPSILON)) {
+                char *follow_A = follow[(unsigned char)grammar[i].lhs];
+                for (int k = 0; follow_A[k] != '\0'; k++) {
+                    add_char(follow[b], follow_A[k]);
+                }
+            }
+        }
+    }
+
+    return (int)strlen(follow[b]) != before;
+}
+
+// Worklist propagation of FIRST, seeded with the non-terminals in dirty.
+// Every non-terminal whose FIRST grew is recorded in grown.
+static void propagate_first(char dirty[256], char grown[256]) {
+    char queue[256];
+    int head = 0, tail = 0;
+    char queued[256] = {0};
+
+    for (int c = 0; c < 256; c++) {
+        if (dirty[c]) {
+            queue[tail++] = c;
+            queued[c] = 1;
+        }
+    }
+    while (head != tail) {
+        char X = queue[head];
+        head = (head + 1) % 256;
+        queued[(unsigned char)X] = 0;
+
+        int changed = 0;
+        for (int i = 0; i < num_productions; i++) {
+            if (grammar[i].lhs == X && apply_first_rule(i)) {
+                changed = 1;
+            }
+        }
+        if (!changed) continue;
+        grown[(unsigned char)X] = 1;
+
+        // Every LHS with X on its right-hand side has to be looked at again
+        for (int i = 0; i < num_productions; i++) {
+            unsigned char A = grammar[i].lhs;
+            if (occurs_in(i, X) && !queued[A]) {
+                queue[tail] = A;
+                tail = (tail + 1) % 256;
+                queued[A] = 1;
+            }
+        }
+    }
+}
+
+// Worklist propagation of FOLLOW, seeded with the non-terminals in dirty
+static void propagate_follow(char dirty[256]) {
+    char queue[256];
+    int head = 0, tail = 0;
+    char queued[256] = {0};
+
+    for (int c = 0; c < 256; c++) {
+        if (dirty[c]) {
+            queue[tail++] = c;
+            queued[c] = 1;
+        }
+    }
+    while (head != tail) {
+        char B = queue[head];
+        head = (head + 1) % 256;
+        queued[(unsigned char)B] = 0;
+
+        if (!apply_follow_rules(B)) continue;
+
+        // FOLLOW(B) flows into the non-terminals of B's own productions
+        for (int i = 0; i < num_productions; i++) {
+            if (grammar[i].lhs != B) continue;
+            for (char *p = grammar[i].rhs; *p; p++) {
+                unsigned char X = *p;
+                if (!is_terminal(X) && !queued[X]) {
+                    queue[tail] = X;
+                    tail = (tail + 1) % 256;
+                    queued[X] = 1;
+                }
+            }
+        }
+    }
+}
+
+// Mark the non-terminals of every production that mentions a symbol in changed.
+// Their FOLLOW sets read FIRST of the symbols after them.
+static void mark_follow_readers(char changed[256], char dirty[256]) {
+    for (int i = 0; i < num_productions; i++) {
+        int touched = 0;
+        for (char *p = grammar[i].rhs; *p; p++) {
+            if (changed[(unsigned char)*p]) touched = 1;
+        }
+        if (!touched) continue;
+        for (char *p = grammar[i].rhs; *p; p++) {
+            if (!is_terminal(*p)) dirty[(unsigned char)*p] = 1;
+        }
+    }
+}
+
+// Returns 0 if the grammar is full, rhs is too long, or its terminals
+// would no longer fit in a set
+int add_production(char lhs, const char *rhs) {
+    if (num_productions == MAX_PROD || strlen(rhs) >= MAX_SYMBOLS) return 0;
+    if (strchr(rhs, EPSILON) || count_terminals(rhs) > MAX_TERMINALS) return 0;
+    grammar[num_productions].lhs = lhs;
+    strcpy(grammar[num_productions].rhs, rhs);
+    num_productions++;
+
+    // Sets only grow, so push the new rule forward from its LHS
+    char first_dirty[256] = {0}, grown[256] = {0};
+    first_dirty[(unsigned char)lhs] = 1;
+    propagate_first(first_dirty, grown);
+
+    char follow_dirty[256] = {0};
+    follow_dirty[(unsigned char)start_symbol] = 1;  // so '$' is there even before any full run
+    for (const char *p = rhs; *p; p++) {
+        if (!is_terminal(*p)) follow_dirty[(unsigned char)*p] = 1;
+    }
+    mark_follow_readers(grown, follow_dirty);
+    propagate_follow(follow_dirty);
+    return 1;
+}
+
+// Returns 0 if the production is not in the grammar
+int remove_production(char lhs, const char *rhs) {
+    int at = -1;
+    for (int i = 0; i < num_productions; i++) {
+        if (grammar[i].lhs == lhs && strcmp(grammar[i].rhs, rhs) == 0) {
+            at = i;
+            break;
+        }
+    }
+    if (at == -1) return 0;
+
+    char follow_dirty[256] = {0};
+    follow_dirty[(unsigned char)start_symbol] = 1;  // so '$' is there even before any full run
+    for (const char *p = rhs; *p; p++) {
+        if (!is_terminal(*p)) follow_dirty[(unsigned char)*p] = 1;
+    }
+    memmove(&grammar[at], &grammar[at + 1], (num_productions - at - 1) * sizeof(grammar[0]));
+    num_productions--;
+
+    // Over-delete: FIRST of lhs and of everything that reads it transitively
+    char doomed[256] = {0};
+    doomed[(unsigned char)lhs] = 1;
+    int grew = 1;
+    while (grew) {
+        grew = 0;
+        for (int i = 0; i < num_productions; i++) {
+            unsigned char A = grammar[i].lhs;
+            if (doomed[A]) continue;
+            for (char *p = grammar[i].rhs; *p; p++) {
+                if (doomed[(unsigned char)*p]) {
+                    doomed[A] = 1;
+                    grew = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Re-derive them, then see which ones actually ended up different
+    char old_first[256][MAX_SYMBOLS];
+    char grown[256] = {0}, changed[256] = {0};
+    for (int c = 0; c < 256; c++) {
+        if (doomed[c]) {
+            strcpy(old_first[c], first[c]);
+            first[c][0] = '\0';
+        }
+    }
+    propagate_first(doomed, grown);
+    for (int c = 0; c < 256; c++) {
+        if (doomed[c] && (strlen(old_first[c]) != strlen(first[c]))) {
+            changed[c] = 1;
+        }
+    }
+
+    // Over-delete FOLLOW the same way: the affected non-terminals plus
+    // everything their FOLLOW sets flow into
+    mark_follow_readers(changed, follow_dirty);
+    grew = 1;
+    while (grew) {
+        grew = 0;
+        for (int i = 0; i < num_productions; i++) {
+            if (!follow_dirty[(unsigned char)grammar[i].lhs]) continue;
+            for (char *p = grammar[i].rhs; *p; p++) {
+                unsigned char X = *p;
+                if (!is_terminal(X) && !follow_dirty[X]) {
+                    follow_dirty[X] = 1;
+                    grew = 1;
+                }
+            }
+        }
+    }
+    for (int c = 0; c < 256; c++) {
+        if (follow_dirty[c]) follow[c][0] = '\0';
+    }
+    propagate_follow(follow_dirty);
+
+    return 1;
+}
+
+// Empty every set, then give each terminal its own FIRST set
+void reset_sets() {
+    memset(first, 0, sizeof(first));
+    memset(follow, 0, sizeof(follow));
+    for (int c = 1; c < 256; c++) {
+        if (is_terminal(c) && c != EPSILON) {
+            first[c][0] = c;
+        }
+    }
+}
+
+// Start over from an empty grammar
+void reset_grammar() {
+    num_productions = 0;
+    reset_sets();
+}
@@ -0,0 +1,46 @@
+#ifndef FOLLOW_H
+#define FOLLOW_H
+
+/*
+ * FIRST and FOLLOW over single-character grammars, with incremental
+ * updates. Non-terminals are A-Z, 'e' and 't'; every other character is
+ * a terminal. Sets are NUL-terminated strings indexed by symbol.
+ */
+
+#define MAX_PROD 100
+#define MAX_SYMBOLS 32
+#define EPSILON '~'   // stands in for ε inside the char sets
+
+// A set holds terminals plus '$' or EPSILON, and the NUL, in MAX_SYMBOLS
+#define MAX_TERMINALS (MAX_SYMBOLS - 3)
+
+struct Production {
+    char lhs;
+    char rhs[MAX_SYMBOLS];
+};
+
+extern int num_productions;
+extern struct Production grammar[MAX_PROD];
+
+extern char first[256][MAX_SYMBOLS];
+extern char follow[256][MAX_SYMBOLS];
+extern char start_symbol;
+
+int is_terminal(char c);
+
+// Distinct terminals in the grammar and in extra, which may be ""
+int count_terminals(const char *extra);
+
+// Full recomputation from whatever the sets hold now
+void compute_first();
+void compute_follow();
+
+// Edit the grammar and update the sets in place; both return 0 if
+// nothing was changed
+int add_production(char lhs, const char *rhs);
+int remove_production(char lhs, const char *rhs);
+
+void reset_sets();
+void reset_grammar();
+
+#endif
@@ -0,0 +1,138 @@
+// Randomised check and latency benchmark for add_production/remove_production.
+//
+//     gcc -O2 test_incremental.c follow.c -o test_incremental
+//     ./test_incremental [rounds]
+//
+// Starting from an empty grammar, each round makes random single edits and
+// after every edit compares FIRST and FOLLOW, set-wise, against a full
+// compute_first()/compute_follow() from scratch. Then it times single
+// edits on a grammar filled close to MAX_PROD.
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "follow.h"
+
+// Every non-terminal the tool accepts. A production of non_terminals[k]
+// mostly uses k itself and the next few non-terminals, with an occasional
+// jump anywhere, so like a real grammar the rules form a long chain of
+// mostly local dependencies and one edit has a limited reach.
+static const char non_terminals[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZet";
+static const char terminals[] = "+*()iabcdfg";
+#define NUM_NT ((int)sizeof(non_terminals) - 1)
+#define NUM_T ((int)sizeof(terminals) - 1)
+
+int same_set(const char *a, const char *b) {
+    if (strlen(a) != strlen(b)) return 0;
+    for (; *a; a++) {
+        if (!strchr(b, *a)) return 0;
+    }
+    return 1;
+}
+
+void random_edit() {
+    if (num_productions > 0 && (num_productions == MAX_PROD || rand() % 3 == 0)) {
+        struct Production p = grammar[rand() % num_productions];
+        remove_production(p.lhs, p.rhs);
+    } else {
+        char rhs[5];
+        int lhs = rand() % NUM_NT;
+        int n = rand() % 5;
+        for (int i = 0; i < n; i++) {
+            if (rand() % 2) {
+                rhs[i] = terminals[rand() % NUM_T];
+            } else if (rand() % 16) {
+                int k = lhs + rand() % 4;  // itself or one of the next three
+                rhs[i] = k < NUM_NT ? non_terminals[k] : terminals[rand() % NUM_T];
+            } else {
+                rhs[i] = non_terminals[rand() % NUM_NT];
+            }
+        }
+        rhs[n] = '\0';
+        add_production(non_terminals[lhs], rhs);
+    }
+}
+
+// Compare the incremental sets with a full recomputation; returns 0 on a mismatch
+int check_against_full() {
+    char inc_first[256][MAX_SYMBOLS], inc_follow[256][MAX_SYMBOLS];
+    memcpy(inc_first, first, sizeof(first));
+    memcpy(inc_follow, follow, sizeof(follow));
+
+    for (int i = 0; non_terminals[i]; i++) {
+        unsigned char nt = non_terminals[i];
+        first[nt][0] = '\0';
+        follow[nt][0] = '\0';
+    }
+    compute_first();
+    compute_follow();
+
+    int ok = 1;
+    for (int i = 0; non_terminals[i]; i++) {
+        unsigned char nt = non_terminals[i];
+        if (!same_set(inc_first[nt], first[nt]) || !same_set(inc_follow[nt], follow[nt])) {
+            printf("MISMATCH at %c: FIRST {%s} vs {%s}, FOLLOW {%s} vs {%s}\n",
+                   nt, inc_first[nt], first[nt], inc_follow[nt], follow[nt]);
+            ok = 0;
+        }
+    }
+    memcpy(first, inc_first, sizeof(first));
+    memcpy(follow, inc_follow, sizeof(follow));
+    return ok;
+}
+
+double seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 2000;
+    long edits = 0;
+
+    srand(1);
+    for (int round = 0; round < rounds; round++) {
+        reset_grammar();
+        for (int step = 0; step < 60; step++) {
+            random_edit();
+            edits++;
+            if (!check_against_full()) {
+                printf("FAILED after %ld edits (round %d)\n", edits, round);
+                return 1;
+            }
+        }
+    }
+    printf("ok: %ld random edits matched full recomputation\n", edits);
+
+    // Latency: single edits on a grammar kept near MAX_PROD productions
+    reset_grammar();
+    while (num_productions < MAX_PROD - 5) random_edit();
+    int samples = 20000;
+    double incremental = 0, full = 0;
+    for (int i = 0; i < samples; i++) {
+        double t0 = seconds();
+        random_edit();
+        incremental += seconds() - t0;
+
+        char saved_first[256][MAX_SYMBOLS], saved_follow[256][MAX_SYMBOLS];
+        memcpy(saved_first, first, sizeof(first));
+        memcpy(saved_follow, follow, sizeof(follow));
+        t0 = seconds();
+        for (int k = 0; non_terminals[k]; k++) {
+            first[(unsigned char)non_terminals[k]][0] = '\0';
+            follow[(unsigned char)non_terminals[k]][0] = '\0';
+        }
+        compute_first();
+        compute_follow();
+        full += seconds() - t0;
+        memcpy(first, saved_first, sizeof(first));
+        memcpy(follow, saved_follow, sizeof(follow));
+    }
+    printf("%d productions: %.2f us per incremental edit, %.2f us per full recompute\n",
+           num_productions, incremental / samples * 1e6, full / samples * 1e6);
+    return 0;
+}
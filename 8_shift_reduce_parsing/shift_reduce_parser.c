@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include "../common/grammar.h"
 
 #define MAX 100       // maximum size for stack and input
 #define MAX_PROD 10   // maximum number of productions
@@ -41,20 +42,27 @@ int reduce(char *stack, char productions[][PROD_SIZE], int numProd) {
     return reduced;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     int numProd, i, pos = 0;
     char productions[MAX_PROD][PROD_SIZE];
     char input[MAX];
     char stack[MAX] = "";
 
-    printf("Enter the number of productions: ");
-    scanf("%d", &numProd);
-    
-    // Read each production rule.
-    // Expected format for each: A->xyz
-    for(i = 0; i < numProd; i++) {
-        printf("Enter production %d: ", i + 1);
-        scanf("%s", productions[i]);
+    if(argc > 1) {
+        // Read the productions from a grammar file instead of the prompt.
+        numProd = grammar_load_productions(argv[1], productions[0], MAX_PROD, PROD_SIZE, 0);
+        if(numProd == -1)
+            return 1;
+    } else {
+        printf("Enter the number of productions: ");
+        scanf("%d", &numProd);
+
+        // Read each production rule.
+        // Expected format for each: A->xyz
+        for(i = 0; i < numProd; i++) {
+            printf("Enter production %d: ", i + 1);
+            scanf("%s", productions[i]);
+        }
     }
 
     // The start symbol is assumed to be the LHS of the first production.
@@ -2,10 +2,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <unistd.h>
+#include "../common/grammar.h"
 
 #define MAX 10  // Max number of non-terminals
 #define PROD_SIZE 20 // Max size of each production
 
+#define CACHE_FILE "lead_trail-%016llx.cache"  // one file per grammar hash
+#define CACHE_MAGIC 0x3143544Cu  // "LTC1"
+#define CACHE_VERSION 1
+
 // Structure to store leading and trailing sets
 typedef struct {
     char nonTerminal;
@@ -18,6 +24,16 @@ typedef struct {
 SymbolSet symbols[MAX]; // Stores leading and trailing sets
 int numProductions;
 
+// On-disk cache of the computed sets, keyed by a hash of the productions.
+// Flat and fixed-size so it can be read in one go or mmap'd directly.
+typedef struct {
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long grammarHash;
+    int numSymbols;
+    SymbolSet symbols[MAX];
+} AnalysisCache;
+
 // Function to add a symbol to the set if not already present
 void addSymbol(char *set, int *count, char symbol) {
     for (int i = 0; i < *count; i++) {
@@ -104,35 +120,108 @@ void computeTrailing(char productions[MAX][PROD_SIZE], int numSymbols) {
     }
 }
 
-int main() {
-    int numSymbols;
-    char productions[MAX][PROD_SIZE];
+// FNV-1a hash over the productions, in input order
+unsigned long long hashGrammar(char productions[MAX][PROD_SIZE]) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (int i = 0; i < numProductions; i++) {
+        for (char *p = productions[i]; *p; p++)
+            h = (h ^ (unsigned char)*p) * 1099511628211ULL;
+        h = (h ^ '\n') * 1099511628211ULL; // Production separator
+    }
+    return h;
+}
 
-    // Get number of productions
-    printf("Enter the number of productions: ");
-    scanf("%d", &numProductions);
+// Function to load cached sets; returns the number of symbols, or -1 on a miss
+int loadCache(unsigned long long hash) {
+    AnalysisCache cache;
+    char path[64];
+    snprintf(path, sizeof(path), CACHE_FILE, hash);
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) return -1;
+    size_t n = fread(&cache, sizeof(cache), 1, fp);
+    fclose(fp);
+
+    if (n != 1 || cache.magic != CACHE_MAGIC || cache.version != CACHE_VERSION ||
+        cache.grammarHash != hash || cache.numSymbols < 0 || cache.numSymbols > MAX)
+        return -1;
+
+    // Counts are used as loop bounds, so a damaged file counts as a miss
+    for (int i = 0; i < cache.numSymbols; i++) {
+        if (cache.symbols[i].leadCount < 0 || cache.symbols[i].leadCount > MAX ||
+            cache.symbols[i].trailCount < 0 || cache.symbols[i].trailCount > MAX)
+            return -1;
+    }
 
-    // Read productions
-    printf("Enter the productions (Format: A->xyz):\n");
-    for (int i = 0; i < numProductions; i++) {
-        scanf("%s", productions[i]);
+    memcpy(symbols, cache.symbols, sizeof(symbols));
+    return cache.numSymbols;
+}
+
+// Function to store the computed sets (written to a temp file, then renamed)
+void saveCache(unsigned long long hash, int numSymbols) {
+    AnalysisCache cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = CACHE_MAGIC;
+    cache.version = CACHE_VERSION;
+    cache.grammarHash = hash;
+    cache.numSymbols = numSymbols;
+    memcpy(cache.symbols, symbols, sizeof(symbols));
+
+    // The temp name is unique per process so parallel writers never share a file
+    char path[64], tmp[80];
+    snprintf(path, sizeof(path), CACHE_FILE, hash);
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+    FILE *fp = fopen(tmp, "wb");
+    if (fp == NULL) return; // Caching is best-effort
+    size_t n = fwrite(&cache, sizeof(cache), 1, fp);
+    if (fclose(fp) != 0 || n != 1) {
+        remove(tmp);
+        return;
     }
+    rename(tmp, path);
+}
 
-    // Get unique non-terminals
-    numSymbols = 0;
-    for (int i = 0; i < numProductions; i++) {
-        char lhs = productions[i][0];
-        if (findIndex(lhs, numSymbols) == -1) { // Check if already added
-            symbols[numSymbols].nonTerminal = lhs;
-            symbols[numSymbols].leadCount = 0;
-            symbols[numSymbols].trailCount = 0;
-            numSymbols++;
+int main(int argc, char *argv[]) {
+    int numSymbols;
+    char productions[MAX][PROD_SIZE];
+
+    if (argc > 1) {
+        // Read productions from a grammar file
+        numProductions = grammar_load_productions(argv[1], productions[0], MAX, PROD_SIZE, 0);
+        if (numProductions == -1) return 1;
+    } else {
+        // Get number of productions
+        printf("Enter the number of productions: ");
+        scanf("%d", &numProductions);
+
+        // Read productions
+        printf("Enter the productions (Format: A->xyz):\n");
+        for (int i = 0; i < numProductions; i++) {
+            scanf("%s", productions[i]);
         }
     }
 
-    // Compute leading and trailing sets
-    computeLeading(productions, numSymbols);
-    computeTrailing(productions, numSymbols);
+    // Reuse the cached sets if this grammar was analysed before
+    unsigned long long hash = hashGrammar(productions);
+    numSymbols = loadCache(hash);
+    if (numSymbols == -1) {
+        // Get unique non-terminals
+        numSymbols = 0;
+        for (int i = 0; i < numProductions; i++) {
+            char lhs = productions[i][0];
+            if (findIndex(lhs, numSymbols) == -1) { // Check if already added
+                symbols[numSymbols].nonTerminal = lhs;
+                symbols[numSymbols].leadCount = 0;
+                symbols[numSymbols].trailCount = 0;
+                numSymbols++;
+            }
+        }
+
+        // Compute leading and trailing sets
+        computeLeading(productions, numSymbols);
+        computeTrailing(productions, numSymbols);
+
+        saveCache(hash, numSymbols);
+    }
 
     // Display results
     printf("\nLEADING and TRAILING sets:\n");
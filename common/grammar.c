@@ -0,0 +1,275 @@
+#define _POSIX_C_SOURCE 200809L  // getline
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "grammar.h"
+
+// Grow *buf so that it holds at least need elements of elem bytes
+static void reserve(void **buf, size_t *cap, size_t need, size_t elem) {
+    if (need <= *cap) return;
+    size_t new_cap = *cap ? *cap : 64;
+    while (new_cap < need) new_cap *= 2;
+    void *p = realloc(*buf, new_cap * elem);
+    if (p == NULL) {
+        fprintf(stderr, "grammar: out of memory\n");
+        exit(1);
+    }
+    *buf = p;
+    *cap = new_cap;
+}
+
+static unsigned int hash_name(const char *name, size_t len) {
+    unsigned int h = 2166136261u;  // FNV-1a
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ (unsigned char)name[i]) * 16777619u;
+    return h;
+}
+
+void grammar_init(Grammar *g) {
+    memset(g, 0, sizeof(*g));
+    g->start_symbol = -1;
+}
+
+void grammar_free(Grammar *g) {
+    free(g->names);
+    free(g->name_offset);
+    free(g->nonterminal);
+    free(g->slots);
+    free(g->arena);
+    free(g->prod_offset);
+    grammar_init(g);
+}
+
+// Double the hash table and re-insert every symbol
+static void rehash(Grammar *g) {
+    int cap = g->slots_cap ? g->slots_cap * 2 : 256;
+    int *slots = malloc(cap * sizeof(int));
+    if (slots == NULL) {
+        fprintf(stderr, "grammar: out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < cap; i++) slots[i] = -1;
+
+    for (int sym = 0; sym < g->num_symbols; sym++) {
+        const char *name = grammar_symbol_name(g, sym);
+        unsigned int i = hash_name(name, strlen(name)) & (cap - 1);
+        while (slots[i] != -1) i = (i + 1) & (cap - 1);
+        slots[i] = sym;
+    }
+    free(g->slots);
+    g->slots = slots;
+    g->slots_cap = cap;
+}
+
+int grammar_intern(Grammar *g, const char *name, size_t len) {
+    // Keep the table at most half full
+    if (2 * (g->num_symbols + 1) > g->slots_cap) rehash(g);
+
+    unsigned int i = hash_name(name, len) & (g->slots_cap - 1);
+    while (g->slots[i] != -1) {
+        const char *other = grammar_symbol_name(g, g->slots[i]);
+        if (strncmp(other, name, len) == 0 && other[len] == '\0')
+            return g->slots[i];
+        i = (i + 1) & (g->slots_cap - 1);
+    }
+
+    int sym = g->num_symbols++;
+    reserve((void **)&g->names, &g->names_cap, g->names_len + len + 1, 1);
+    memcpy(g->names + g->names_len, name, len);
+    g->names[g->names_len + len] = '\0';
+
+    size_t cap = g->symbols_cap;
+    reserve((void **)&g->name_offset, &cap, g->num_symbols, sizeof(size_t));
+    reserve((void **)&g->nonterminal, &g->symbols_cap, g->num_symbols, 1);
+    g->name_offset[sym] = g->names_len;
+    g->nonterminal[sym] = 0;
+    g->names_len += len + 1;
+
+    g->slots[i] = sym;
+    return sym;
+}
+
+// Open a new production for lhs at the end of the arena
+static void begin_production(Grammar *g, int lhs) {
+    reserve((void **)&g->prod_offset, &g->prods_cap, g->num_productions + 1, sizeof(size_t));
+    g->prod_offset[g->num_productions++] = g->arena_len;
+    reserve((void **)&g->arena, &g->arena_cap, g->arena_len + 2, sizeof(int));
+    g->arena[g->arena_len++] = lhs;
+    g->arena[g->arena_len++] = 0;
+}
+
+// Append a symbol to the production opened last
+static void push_symbol(Grammar *g, int sym) {
+    reserve((void **)&g->arena, &g->arena_cap, g->arena_len + 1, sizeof(int));
+    g->arena[g->arena_len++] = sym;
+    g->arena[g->prod_offset[g->num_productions - 1] + 1]++;
+}
+
+static int is_epsilon(const char *s, size_t len) {
+    return (len == 2 && memcmp(s, "\xCE\xB5", 2) == 0)  // UTF-8 ε
+        || (len == 7 && memcmp(s, "epsilon", 7) == 0)
+        || (len == 3 && memcmp(s, "eps", 3) == 0);
+}
+
+enum { TOK_END, TOK_SYMBOL, TOK_ARROW, TOK_ALT };
+
+// Scan the next token of a line; symbols are returned as [*start, *start + *len)
+static int next_token(const char **p, const char **start, size_t *len) {
+    const char *s = *p;
+    while (isspace((unsigned char)*s)) s++;
+
+    if (*s == '\0' || *s == '#') {
+        *p = s;
+        return TOK_END;
+    }
+    if (*s == '|') {
+        *p = s + 1;
+        return TOK_ALT;
+    }
+    if (strncmp(s, "->", 2) == 0) {
+        *p = s + 2;
+        return TOK_ARROW;
+    }
+    if (strncmp(s, "::=", 3) == 0) {
+        *p = s + 3;
+        return TOK_ARROW;
+    }
+
+    *start = s;
+    while (*s && !isspace((unsigned char)*s) && *s != '|' && *s != '#'
+           && strncmp(s, "->", 2) != 0)
+        s++;
+    *len = s - *start;
+    *p = s;
+    return TOK_SYMBOL;
+}
+
+// Parse one line; lhs carries the rule being continued across lines
+static int parse_line(Grammar *g, const char *line, const char *name, int line_no, int *lhs) {
+    const char *p = line, *start, *next;
+    size_t len, next_len;
+    int tok = next_token(&p, &start, &len);
+
+    if (tok == TOK_END) return 0;
+    if (tok == TOK_SYMBOL) {
+        const char *after = p;
+        if (next_token(&after, &next, &next_len) != TOK_ARROW) {
+            fprintf(stderr, "%s:%d: expected '->' after '%.*s'\n", name, line_no, (int)len, start);
+            return -1;
+        }
+        p = after;
+        *lhs = grammar_intern(g, start, len);
+        g->nonterminal[*lhs] = 1;
+        if (g->start_symbol == -1) g->start_symbol = *lhs;
+    } else if (tok != TOK_ALT || *lhs == -1) {
+        fprintf(stderr, "%s:%d: expected a rule 'A -> ...'\n", name, line_no);
+        return -1;
+    }
+
+    // Each pass of this loop reads one alternative
+    for (;;) {
+        int symbols = 0, epsilon = 0;
+        begin_production(g, *lhs);
+        while ((tok = next_token(&p, &start, &len)) == TOK_SYMBOL) {
+            if (is_epsilon(start, len)) {
+                epsilon = 1;
+            } else {
+                push_symbol(g, grammar_intern(g, start, len));
+            }
+            symbols++;
+        }
+        if (tok == TOK_ARROW) {
+            fprintf(stderr, "%s:%d: unexpected '->'\n", name, line_no);
+            return -1;
+        }
+        if (symbols == 0 || (epsilon && symbols > 1)) {
+            fprintf(stderr, "%s:%d: empty alternative (write ε for the empty string)\n", name, line_no);
+            return -1;
+        }
+        if (tok == TOK_END) return 0;
+    }
+}
+
+int grammar_load(Grammar *g, FILE *fp, const char *name) {
+    char *line = NULL;
+    size_t cap = 0;
+    int line_no = 0, lhs = -1, status = 0;
+
+    // Lines are streamed one at a time, so the file can be any size
+    while (getline(&line, &cap, fp) != -1) {
+        line_no++;
+        if (parse_line(g, line, name, line_no, &lhs) != 0) {
+            status = -1;
+            break;
+        }
+    }
+    free(line);
+    return status;
+}
+
+int grammar_load_file(Grammar *g, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        perror(path);
+        return -1;
+    }
+    int status = grammar_load(g, fp, path);
+    fclose(fp);
+    return status;
+}
+
+int grammar_format_production(const Grammar *g, int prod, char *buf, size_t size) {
+    int n = grammar_rhs_length(g, prod);
+    const int *rhs = grammar_rhs(g, prod);
+    const char *lhs = grammar_symbol_name(g, grammar_lhs(g, prod));
+
+    if (strlen(lhs) != 1 || size < 4) return -1;
+    buf[0] = lhs[0];
+    memcpy(buf + 1, "->", 2);
+
+    // Longer symbols are spelled out character by character, so "S->S+S"
+    // (read as the one symbol "S+S") comes back as the same row
+    size_t at = 3;
+    for (int i = 0; i < n; i++) {
+        const char *name = grammar_symbol_name(g, rhs[i]);
+        size_t len = strlen(name);
+        if (at + len >= size) return -1;
+        memcpy(buf + at, name, len);
+        at += len;
+    }
+    buf[at] = '\0';
+    return 0;
+}
+
+int grammar_load_productions(const char *path, char *rows, int max, size_t size, int allow_epsilon) {
+    Grammar g;
+    grammar_init(&g);
+    if (grammar_load_file(&g, path) != 0) {
+        grammar_free(&g);
+        return -1;
+    }
+
+    int count = g.num_productions;
+    if (count == 0) {
+        fprintf(stderr, "%s: no productions\n", path);
+        count = -1;
+    } else if (count > max) {
+        fprintf(stderr, "%s: %d productions, at most %d supported\n", path, count, max);
+        count = -1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (grammar_rhs_length(&g, i) == 0 && !allow_epsilon) {
+            fprintf(stderr, "%s: ε-productions are not supported here\n", path);
+            count = -1;
+        } else if (grammar_format_production(&g, i, rows + i * size, size) != 0) {
+            fprintf(stderr, "%s: production %d needs a single-character LHS "
+                    "and at most %zu characters\n", path, i + 1, size - 1);
+            count = -1;
+        }
+    }
+    grammar_free(&g);
+    return count;
+}
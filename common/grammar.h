@@ -0,0 +1,96 @@
+#ifndef GRAMMAR_H
+#define GRAMMAR_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/*
+ * Shared grammar-file loader.
+ *
+ * File format (one rule per line, any size of file):
+ *
+ *     # a '#' starts a comment, even right after a symbol
+ *     expr -> expr + term | term
+ *     term -> term * factor
+ *           | factor            # a line starting with | continues the rule
+ *     opt  -> ε                 # "ε", "epsilon" or "eps" is the empty string
+ *
+ * Symbols are separated by whitespace and may be any length; "->" and
+ * "|" also end a symbol, so "A->xyz" is the rule A -> xyz with the one
+ * symbol "xyz". "::=" is accepted in place of "->". A symbol is a
+ * non-terminal if it appears on the left of some rule; the start symbol
+ * is the first LHS in the file.
+ *
+ * Symbols are interned to dense integer ids. Productions are stored back
+ * to back in one int arena as [lhs, length, rhs...], so a production is
+ * just an offset into that array.
+ */
+
+typedef struct {
+    /* Symbol table: names live in one char arena, looked up by hash */
+    char *names;
+    size_t names_len, names_cap;
+    size_t *name_offset;        /* symbol id -> offset into names */
+    unsigned char *nonterminal; /* symbol id -> 1 if it is some rule's LHS */
+    int num_symbols;
+    size_t symbols_cap;
+    int *slots;                 /* open-addressing table of symbol ids, -1 = empty */
+    int slots_cap;
+
+    /* Productions: [lhs, length, rhs...] packed back to back */
+    int *arena;
+    size_t arena_len, arena_cap;
+    size_t *prod_offset;        /* production index -> offset into arena */
+    int num_productions;
+    size_t prods_cap;
+
+    int start_symbol;           /* -1 until the first rule is read */
+} Grammar;
+
+void grammar_init(Grammar *g);
+void grammar_free(Grammar *g);
+
+/*
+ * Read rules from fp. Returns 0 on success, -1 on a syntax error, which is
+ * reported on stderr as "name:line: ..."
+ */
+int grammar_load(Grammar *g, FILE *fp, const char *name);
+int grammar_load_file(Grammar *g, const char *path);
+
+/* Return the id of a symbol, adding it to the table if it is new */
+int grammar_intern(Grammar *g, const char *name, size_t len);
+
+static inline const char *grammar_symbol_name(const Grammar *g, int sym) {
+    return g->names + g->name_offset[sym];
+}
+
+static inline int grammar_lhs(const Grammar *g, int prod) {
+    return g->arena[g->prod_offset[prod]];
+}
+
+static inline int grammar_rhs_length(const Grammar *g, int prod) {
+    return g->arena[g->prod_offset[prod] + 1];
+}
+
+static inline const int *grammar_rhs(const Grammar *g, int prod) {
+    return g->arena + g->prod_offset[prod] + 2;
+}
+
+/*
+ * Write production prod as "A->xyz" for the tools that work on
+ * single-character symbols. Right-hand symbols longer than one character
+ * are spelled out, so a file in the old "A->xyz" format loads unchanged.
+ * An ε-production becomes "A->". Returns -1 if the LHS is longer than one
+ * character or the result does not fit in size bytes.
+ */
+int grammar_format_production(const Grammar *g, int prod, char *buf, size_t size);
+
+/*
+ * Load a grammar file straight into the "A->xyz" string tables used by
+ * the tools: up to max rows of size bytes each, starting at rows.
+ * ε-productions are rejected unless allow_epsilon is set.
+ * Returns the number of productions, or -1 after reporting an error.
+ */
+int grammar_load_productions(const char *path, char *rows, int max, size_t size, int allow_epsilon);
+
+#endif